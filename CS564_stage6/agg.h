@@ -0,0 +1,119 @@
+#ifndef AGG_H
+#define AGG_H
+
+#include "catalog.h"
+#include "query.h"
+#include "exec.h"
+
+
+// define if debug output wanted
+//#define DEBUGAGG
+
+
+// Hash aggregation of the rows of a query into one tuple per group of
+// equal GROUP BY values. A table in memory has an entry for every
+// group, with the count, sum, minimum and maximum of each aggregate so
+// far; it holds as many groups as fit in the frames the buffer pool
+// can spare. The rows of a group that does not fit go to an overflow
+// file. When the input ends the groups in memory are written out, and
+// the overflow file is split by Partition into files of fewer groups:
+// while it is split, the groups that fit in memory are folded as
+// resident records, and every partition file is aggregated in turn
+// the same way. Without GROUP BY all rows form one group, which is
+// folded in place.
+//
+// A row is folded as an input record: the GROUP BY values, which make
+// up its key, followed by the value of every aggregate, in the order
+// of the projection list. The overflow and partition files hold
+// such records.
+
+class HashAgg
+{
+ public:
+  // the projection list of the query: projected attribute i of
+  // relation projRels[i] is aggregated by aggs[i], or is one of the
+  // groupCnt GROUP BY attributes if aggs[i] is NoAgg. name is the
+  // base name of the overflow and partition files.
+  HashAgg(const string & name, const int projCnt, const AttrDesc projAttrs[],
+	  const int projRels[], const AggFunc aggs[], const int groupCnt,
+	  const AttrDesc groupAttrs[], const int groupRels[],
+	  Status & status);
+  ~HashAgg();
+
+  // fold the tuples of row into their group
+  const Status add(const Row & row);
+
+  // write a tuple for every group into result, no more than limit of
+  // them if limit >= 0
+  const Status finish(InsertFileScan & result, const int limit,
+		      int & resultCnt);
+
+ private:
+  struct AggAcc {
+    double sum, min, max;
+    int count;
+  };
+
+  unsigned int hash(const char* key) const;
+  int find(const char* key, const unsigned int h) const;
+  void setCap(const int frames);
+  void clear();
+  void newEntry(const int i, const unsigned int h, const char* in);
+  void fold(const char* in, const int e);
+  const Status fold(const char* in);
+  const Status spill(const char* in);
+  const Status writeGroups(InsertFileScan & result, const int limit,
+			   int & resultCnt);
+  const Status aggFile(const string & fileName, const string & base,
+		       const int depth, InsertFileScan & result,
+		       const int limit, int & resultCnt);
+  AggAcc* accOf(const int e, const int a) {
+    return (AggAcc *) &arena[e * entryLen + accOffset] + a;
+  }
+
+  // Partition only hands records to these, so the aggregation in
+  // progress is cur
+  static HashAgg* cur;
+  static const int partHash(const Record & rec, const int P);
+  static const Status keep(const Record & rec);
+
+  string name;
+  int projCnt;
+  const AttrDesc* projAttrs;
+  const int* projRels;
+  const AggFunc* aggs;
+  int groupCnt;
+  const AttrDesc* groupAttrs;
+  const int* groupRels;
+  vector<int> pos;		// projected attribute i: offset of its
+				// value in the key, or # of its aggregate
+  int keyLen;			// bytes of the GROUP BY values
+  int aggCnt;			// # of aggregates
+  int inLen;			// bytes of an input record
+  char* in;			// the input record of a row
+
+  // the groups in memory: entry e, at e * entryLen in arena, is the key
+  // and then the aggregates from accOffset on; slot[i] is the entry of
+  // a key with hash slotHash[i], -1 if free
+  vector<char> arena;
+  int entryLen;
+  int accOffset;
+  int entryCnt;
+  int cap;			// max. # of entries
+  vector<int> slot;
+  vector<unsigned int> slotHash;
+  int seed;			// selects the hash function of a level
+  int lastSlot;			// slot partHash() found for a record
+  unsigned int lastHash;
+
+  int budget;			// frames of the table in memory
+  InsertFileScan* over;		// overflow file, NULL until needed
+  string overName;
+
+  int inCnt;			// # of rows folded
+  int spillCnt;			// # of input records written to files
+  int partCnt;			// # of partition files
+  double maxSkew;		// largest skew of a partitioning
+};
+
+#endif
@@ -0,0 +1,48 @@
+#ifndef BLOOM_H
+#define BLOOM_H
+
+#include "catalog.h"
+
+
+// A Bloom filter on the values of a join attribute, built from the
+// keys of one join input and tested with the keys of the other: a key
+// that was added always passes, a key that was not passes with a small
+// probability, the false positive rate. The filter is split into
+// blocks of 256 bits, eight words of 32. A key hashes to one block and
+// sets one bit in each of its words, so a test reads one cache line.
+
+#define BLOOMWORDS 8
+
+class BloomFilter
+{
+private:
+    AttrDesc	attr;		// the attribute whose values are added
+    int		blockCnt;	// # of blocks
+    unsigned int *bits;		// blockCnt blocks of BLOOMWORDS words
+    int		addCnt;		// # of keys added
+
+    unsigned long long hash(const char* key) const;
+
+public:
+    // a filter for about n keys, bitsPerKey bits for each
+    BloomFilter(const int n, const AttrDesc & attr, const int bitsPerKey);
+    ~BloomFilter();
+
+    // add the attribute value at key
+    void add(const char* key);
+
+    // false if the value at key was certainly not added
+    bool mayContain(const char* key) const;
+
+    // bytes of the bit array
+    int bytes() const;
+
+    // # of keys added
+    int count() const { return addCnt; }
+
+    // the probability that a key that was not added passes, as
+    // estimated from the bits that are set
+    double falsePositiveRate() const;
+};
+
+#endif
@@ -0,0 +1,138 @@
+#ifndef BTREE_H
+#define BTREE_H
+
+#include "catalog.h"
+
+
+// define if debug output wanted
+//#define DEBUGBTREE
+
+
+// max. # of (key, RID) items held in memory by the SortedFile that
+// feeds a bulk build
+#define BTREESORTITEMS 1000
+
+
+// An index on attribute attrName of relation relName is stored in a
+// db file called relName.attrName.idx. The first page of the file is
+// a BTreeHdrPage, all other pages are BTreeNodePages.
+
+struct BTreeHdrPage
+{
+  char		relName[MAXNAME];	// relation the index is defined on
+  char		attrName[MAXNAME];	// indexed attribute
+  int		attrOffset;		// offset of attribute in tuple
+  int		attrType;		// INTEGER, FLOAT, or STRING
+  int		attrLen;		// length of attribute in bytes
+  int		rootPageNo;		// page number of root node
+  int		height;			// # of levels above the leaves
+};
+
+
+// Every node has a small fixed header followed by an array of fixed
+// size entries. Entries are ordered on (key, RID) so that duplicate
+// key values are still unique in the tree.
+//
+//   leaf entry:     key | RID
+//   internal entry: key | RID | child pageNo
+//
+// In an internal node leftChild holds the entries smaller than the
+// first separator; the child of separator i holds the entries that
+// are >= separator i and < separator i+1. Leaves are chained through
+// nextPage (-1 on the last leaf) for range iteration.
+
+const unsigned BTNODEFIXED = 4 * sizeof(int);
+
+struct BTreeNodePage
+{
+  int		level;			// 0 for leaves
+  int		keyCnt;			// # of entries in use
+  int		nextPage;		// right sibling (leaves only)
+  int		leftChild;		// leftmost child (internal only)
+  char		data[PAGESIZE - BTNODEFIXED];
+};
+
+
+class BTreeIndex {
+ public:
+  // open an existing index on relation.attrName
+  BTreeIndex(const string & relation, const string & attrName,
+	     Status & status);
+
+  // unpin any pinned pages and close the index file
+  ~BTreeIndex();
+
+  // create the index file and bulk load it from the relation
+  static const Status createIndex(const string & relation,
+				  const AttrDesc & attr);
+
+  // remove the index file
+  static const Status destroyIndex(const string & relation,
+				   const string & attrName);
+
+  // name of the db file holding the index
+  static const string indexName(const string & relation,
+				const string & attrName);
+
+  // add (key, rid) to the index; key points to the attribute value
+  const Status insertEntry(const char* key, const RID & rid);
+
+  // remove (key, rid) from the index
+  const Status deleteEntry(const char* key, const RID & rid);
+
+  // Start a range scan. lowOp must be GT or GTE, highOp LT or LTE.
+  // A NULL bound leaves that end of the range open, so
+  // startScan(NULL, GTE, NULL, LTE) walks the whole index in order.
+  const Status startScan(const char* lowVal, const Operator lowOp,
+			 const char* highVal, const Operator highOp);
+
+  // return RID of next entry in key order, NOMORERECS at end of range
+  const Status scanNext(RID & outRid);
+
+  // terminate the scan
+  const Status endScan();
+
+ private:
+  File*		filePtr;		// underlying DB File object
+  BTreeHdrPage*	headerPage;		// pinned header page
+  int		headerPageNo;		// page number of header page
+  bool		hdrDirtyFlag;		// true if header page was updated
+
+  int		keyLen;			// attrLen of indexed attribute
+  Datatype	keyType;		// type of indexed attribute
+  int		leafEntrySize;		// bytes per leaf entry
+  int		intEntrySize;		// bytes per internal entry
+  int		leafCap;		// max. # of entries in a leaf
+  int		intCap;			// max. # of entries in internal node
+
+  // scan state
+  BTreeNodePage* curPage;		// leaf pinned by the scan
+  int		curPageNo;		// its page number
+  int		curEntry;		// next entry to return
+  char*		highKey;		// upper bound, NULL if open
+  Operator	highOp;			// LT or LTE
+
+  void makeKey(char* dst, const char* src) const;
+  int keycmp(const char* k1, const char* k2) const;
+  int entrycmp(const char* k1, const RID & r1,
+	       const char* k2, const RID & r2) const;
+
+  int findChild(const BTreeNodePage* node, const char* key,
+		const RID & rid) const;
+  int findSlot(const BTreeNodePage* node, const char* key,
+	       const RID & rid) const;
+  const Status findLeaf(const char* key, const RID & rid, int & pageNo);
+  const Status insertInto(const int pageNo, const char* entry,
+			  bool & split, char* upEntry, int & newPageNo);
+  const Status bulkLoad(const string & relation, const string & tmpName);
+  const Status appendLeaf(BTreeNodePage* & leaf, int & leafPageNo,
+			  const char* entry, vector<char> & firstEntries,
+			  vector<int> & pages);
+
+  char* entryAt(BTreeNodePage* node, const int i) const;
+  const char* entryAt(const BTreeNodePage* node, const int i) const;
+  const RID entryRid(const char* entry) const;
+  const int entryChild(const char* entry) const;
+};
+
+#endif
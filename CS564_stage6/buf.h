@@ -82,12 +82,15 @@ private:
 struct BufStats
 {
   int accesses;    // Total number of accesses to buffer pool
-  int diskreads;   // Number of pages read from disk (including allocs)
+  int hits;        // Number of pages read that were in the pool
+  int misses;      // and that were not
+  int diskreads;   // Number of pages read from disk (not from a
+                   // temporary file in memory)
   int diskwrites;  // Number of pages written back to disk
 
   void clear()
     {
-      accesses = diskreads = diskwrites = 0;
+      accesses = hits = misses = diskreads = diskwrites = 0;
     }
       
   BufStats()
@@ -128,6 +131,8 @@ public:
   const Status disposePage(File* file, const int PageNo); // dispose of page in file
   void  printSelf();
 
+  const int numUnpinned() const; // # of frames not pinned by anyone
+
   const BufStats & getBufStats() const // get buffer pool usage
   {
 	return bufStats;
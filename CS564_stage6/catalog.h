@@ -10,6 +10,8 @@
 
 #define RELCATNAME   "relcat"           // name of relation catalog
 #define ATTRCATNAME  "attrcat"          // name of attribute catalog
+#define STATCATNAME  "statcat"          // name of statistics catalog
+#define TMPRELNAME   "Tmp_Minirel_Result" // query result, in memory
 #define MAXNAME      32                 // length of relName, attrName
 #define MAXSTRINGLEN 255                // max. length of string attribute
 
@@ -34,7 +36,43 @@ typedef struct {
 } attrInfo; 
 
 
+// Both catalogs keep an in-memory copy of their tuples, hashed on the
+// relation name. The copy is loaded when the catalog is opened and
+// kept current by addInfo/removeInfo, so lookups never have to scan
+// the catalog files through the buffer pool.
+
+struct relCacheBucket
+{
+  RelDesc rd;                           // cached relcat tuple
+  relCacheBucket* next;                 // next node in the hash table
+};
+
+
+class RelCacheTbl
+{
+ private:
+  int HTSIZE;
+  relCacheBucket** ht;                  // actual hash table
+
+ public:
+  RelCacheTbl();
+  ~RelCacheTbl();
+
+  // returns OK, or HASHTBLERROR if the relation is cached already
+  Status insert(const RelDesc & rd);
+
+  // returns OK and a copy of the tuple if found, else HASHNOTFOUND
+  Status find(const string & relation, RelDesc & rd);
+
+  // returns OK, or HASHNOTFOUND if the relation is not cached
+  Status erase(const string & relation);
+};
+
+
 class RelCatalog : public HeapFile {
+ private:
+  RelCacheTbl cache;                    // copy of relcat
+
  public:
   // open relation catalog
   RelCatalog(Status &status);
@@ -56,6 +94,12 @@ class RelCatalog : public HeapFile {
   // destroy a relation
   const Status destroyRel(const string & relation);
 
+  // build a B+-tree index on an attribute of a relation
+  const Status addIndex(const string & relation, const string & attrName);
+
+  // drop the index on an attribute (or all indices if attrName is empty)
+  const Status dropIndex(const string & relation, const string & attrName);
+
   // print catalog information
   const Status help(const string & relation);          // relation may be NULL
 
@@ -70,6 +114,7 @@ class RelCatalog : public HeapFile {
 //   attribute number : integer(4)
 //   attribute type : integer(4)  (type is Datatype actually)
 //   attribute size : integer(4)
+//   indexed : integer(4)
 
 
 typedef struct {
@@ -78,13 +123,53 @@ typedef struct {
   int attrOffset;                       // attribute offset
   int attrType;                         // attribute type
   int attrLen;                          // attribute length
+  int indexed;                          // TRUE if a B+-tree index exists
 } AttrDesc;
 
 
+struct attrCacheBucket
+{
+  string relName;                       // relation name
+  vector<AttrDesc> attrs;               // its attrcat tuples, in order
+  attrCacheBucket* next;                // next node in the hash table
+};
+
+
+class AttrCacheTbl
+{
+ private:
+  int HTSIZE;
+  attrCacheBucket** ht;                 // actual hash table
+
+ public:
+  AttrCacheTbl();
+  ~AttrCacheTbl();
+
+  // append an attribute to the list of its relation
+  Status insert(const AttrDesc & ad);
+
+  // returns OK and the attributes of relation, else HASHNOTFOUND
+  Status find(const string & relation, vector<AttrDesc>*& attrs);
+
+  // returns OK, or HASHNOTFOUND if the attribute is not cached
+  Status erase(const string & relation, const string & attrName);
+};
+
+
 class AttrCatalog : public HeapFile {
  friend class RelCatalog;
 
+ private:
+  AttrCacheTbl cache;                   // copy of attrcat
+
  public:
+  // Counts the changes to the attributes of relations that exist: a
+  // relation dropped, an index built or dropped. Prepared statements
+  // check the attribute descriptors they hold on to when it moved.
+  // Query results in TMPRELNAME, made and dropped by every selection,
+  // do not count.
+  int version;
+
   // open attribute catalog
   AttrCatalog(Status &status);
 
@@ -99,6 +184,10 @@ class AttrCatalog : public HeapFile {
   // remove tuple from catalog
   const Status removeInfo(const string & relation, const string & attrName);
 
+  // update the indexed flag of an attribute in place
+  const Status setIndexed(const string & relation, const string & attrName,
+			  const int indexed);
+
   // get all attributes of a relation
   const Status getRelInfo(const string & relation, 
 			  int &attrCnt, 
@@ -112,10 +201,82 @@ class AttrCatalog : public HeapFile {
 };
 
 
+// schema of statistics catalog (one tuple per analyzed attribute):
+//   relation name : char(32)           <-- lookup keys
+//   attribute name : char(32)          <--
+//   tuple count : integer(4)
+//   sample count : integer(4)
+//   distinct count : integer(4)
+//   null count : integer(4)
+//   bucket count : integer(4)
+// followed by min, max and the histogram bucket bounds, each stored
+// in STATVALLEN bytes in the binary form of the attribute. Strings
+// longer than STATVALLEN are cut off. These fields are not described
+// in attrcat.
+
+
+#define STATBUCKETS  20                 // buckets of equi-depth histogram
+#define STATVALLEN   16                 // bytes kept of a value
+#define STATSAMPLE   10000              // max. # of tuples sampled
+
+
+typedef struct {
+  char relName[MAXNAME];                // relation name
+  char attrName[MAXNAME];               // attribute name
+  int tupleCnt;                         // # of tuples when analyzed
+  int sampleCnt;                        // # of tuples in the sample
+  int distinctCnt;                      // estimated # of distinct values
+  int nullCnt;                          // # of nulls (none in minirel)
+  int bucketCnt;                        // # of histogram buckets used
+  char minValue[STATVALLEN];            // smallest value
+  char maxValue[STATVALLEN];            // largest value
+  char bounds[STATBUCKETS][STATVALLEN]; // upper bound of each bucket;
+                                        // every bucket holds about
+                                        // sampleCnt / bucketCnt values
+} StatDesc;
+
+
+class StatCatalog : public HeapFile {
+ public:
+  // open statistics catalog
+  StatCatalog(Status &status);
+
+  // get the statistics of an attribute
+  const Status getInfo(const string & relation,
+		       const string & attrName,
+		       StatDesc &record);
+
+  // add (or replace) the statistics of an attribute
+  const Status addInfo(StatDesc & record);
+
+  // remove the statistics of every attribute of a relation
+  const Status dropRelation(const string & relation);
+
+  // Estimated fraction of the tuples of relation for which
+  // "attrName op value" holds. value is in the binary form of the
+  // attribute, as for a scan filter. Without statistics for the
+  // attribute the usual default guesses are returned.
+  const Status selectivity(const string & relation,
+			   const string & attrName,
+			   const Operator op,
+			   const char *value,
+			   double & sel);
+
+  // compare two values as kept in a StatDesc (like strcmp)
+  static int compare(const char *v1, const char *v2,
+		     const int type, const int len);
+
+  // # of bytes of a value of attr kept in a StatDesc
+  static int valueLen(const AttrDesc & attr);
+
+  // close statistics catalog
+  ~StatCatalog();
+};
+
+
 extern RelCatalog  *relCat;
 extern AttrCatalog *attrCat;
+extern StatCatalog *statCat;
 extern Error error;
-extern Status createHeapFile(const string filename);
-extern Status destroyHeapFile(const string filename);
 
 #endif
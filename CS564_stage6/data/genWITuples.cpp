@@ -13,35 +13,47 @@
 
 #define NUMRANDOMIZEPASSES 10
 
+// random position in [0, n), for n beyond RAND_MAX as well
+static int randomPos(int n)
+{
+    long long r = (long long) rand() * ((long long) RAND_MAX + 1) + rand();
+    return (int) (r % n);
+}
+
 int main(int argc, char *argv[])
 {
     // get command line args
-    if (argc != 3)
+    if (argc != 3 && argc != 4)
     {
         fprintf(stderr, 
-                "Usage: %s <total num tuples> <output filename>\n",
+                "Usage: %s <total num tuples> <output filename> [seed]\n",
                 argv[0]);
         return 1;
     }
     int tupleCount = atoi(argv[1]);
     char *outputFilename = argv[2];
 
-    // gen the tuples
-    int nums[tupleCount];
+    // gen the tuples; millions of them do not fit on the stack
+    int *nums = (int *) malloc(tupleCount * sizeof(int));
+    if (NULL == nums)
+    {
+        perror("Error allocating tuples\n");
+        return 1;
+    }
 
     // fill in in order
     for (int i = 0; i < tupleCount; i++)
     {
         nums[i] = i;
     }
-    // randomize
-    srand(time(NULL));
+    // randomize; a seed given makes the data reproducible
+    srand(argc == 4 ? atoi(argv[3]) : time(NULL));
     for (int pass = 0; pass < NUMRANDOMIZEPASSES; pass++)
     {
         for (int i = 0; i < tupleCount; i++)
         {
             // swap curr entry to new pos
-            int newPos = rand() % tupleCount;
+            int newPos = randomPos(tupleCount);
             int tmpVal = nums[newPos];
             nums[newPos] = nums[i];
             nums[i] = tmpVal; 
@@ -49,23 +61,22 @@ int main(int argc, char *argv[])
     }
 
     // write the tuples to the output file
-    int outfd = open(outputFilename, O_WRONLY | O_CREAT | O_TRUNC);
+    int outfd = open(outputFilename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
     if (-1 == outfd)
     {
         perror("Error opening file for writing\n");
         exit(1);
     }
     // write the tuples
-    for (int i = 0; i < tupleCount; i++)
+    if (write(outfd, nums, tupleCount * sizeof(int)) !=
+        (ssize_t) (tupleCount * sizeof(int)))
     {
-        if (write(outfd, &nums[i], sizeof(int)) == -1)
-        {
-            perror("Error writing tuple\n");
-            return 1;
-        }
+        perror("Error writing tuples\n");
+        return 1;
     }
         
     close(outfd);
+    free(nums);
     printf("Done.\n");
     return 0;
 
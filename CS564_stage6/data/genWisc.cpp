@@ -0,0 +1,162 @@
+//=============================================================================
+// Generate tuples of the Wisconsin benchmark relations
+//=============================================================================
+//
+// Writes tupleCount tuples in the binary form `load table' reads, one
+// after the other, for a relation created as
+//
+//   create table R (unique1 int, unique2 int, two int, four int, ten int,
+//       twenty int, onepercent int, tenpercent int, twentypercent int,
+//       fiftypercent int, unique3 int, evenonepercent int,
+//       oddonepercent int, stringu1 char(52), stringu2 char(52),
+//       string4 char(52));
+//
+// which is printed with -s. unique2 numbers the tuples 0, 1, 2, ... in
+// the order of the file, unique1 and unique3 are the same numbers in
+// random order, the other integers are unique1 modulo 2, 4, 10, 20,
+// 100, 10, 5 and 2 (the odd and even one percents twice onepercent,
+// plus one), stringu1 and stringu2 are unique1 and unique2 as seven
+// letters, padded with x, and string4 is AAAA, HHHH, OOOO or VVVV by
+// unique2, padded likewise.
+//
+// The tuples are not held in memory: unique1 is a permutation of
+// unique2, computed tuple by tuple, so there can be as many as an int
+// numbers.
+//
+
+#include <string.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define STRINGLEN 52
+
+struct WiscTuple
+{
+    int unique1, unique2, two, four, ten, twenty, onePercent, tenPercent,
+        twentyPercent, fiftyPercent, unique3, evenOnePercent, oddOnePercent;
+    char stringu1[STRINGLEN], stringu2[STRINGLEN], string4[STRINGLEN];
+};
+
+static unsigned long long mask;         // 2^k - 1, the least >= n - 1
+static int shift;                       // about k / 2
+static unsigned long long key;          // from the seed
+
+// A permutation of [0, mask]: multiplying by an odd number and xoring
+// with a right shift of itself are both one to one on k bits.
+static unsigned long long scramble(unsigned long long x)
+{
+    for (int round = 0; round < 3; round++)
+    {
+        x = (x ^ key) & mask;
+        x = (x * 0x9e3779b97f4a7c15ULL) & mask;
+        x ^= x >> shift;
+    }
+    return x;
+}
+
+// the i-th of a random order of 0 .. n - 1: values of the permutation
+// beyond n - 1 are permuted again until one is not (cycle walking)
+static int permute(unsigned long long i, unsigned long long n)
+{
+    do
+        i = scramble(i);
+    while (i >= n);
+    return (int) i;
+}
+
+// n as seven letters, most significant first, followed by x
+static void wiscString(char *s, int n)
+{
+    memset(s, 'x', STRINGLEN);
+    for (int i = 6; i >= 0; i--)
+    {
+        s[i] = 'A' + n % 26;
+        n /= 26;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc == 2 && strcmp(argv[1], "-s") == 0)
+    {
+        printf("(unique1 int, unique2 int, two int, four int, ten int, "
+               "twenty int, onepercent int, tenpercent int, "
+               "twentypercent int, fiftypercent int, unique3 int, "
+               "evenonepercent int, oddonepercent int, stringu1 char(%d), "
+               "stringu2 char(%d), string4 char(%d))\n",
+               STRINGLEN, STRINGLEN, STRINGLEN);
+        return 0;
+    }
+
+    // get command line args
+    if (argc != 3 && argc != 4)
+    {
+        fprintf(stderr,
+                "Usage: %s <total num tuples> <output filename> [seed]\n"
+                "       %s -s\n", argv[0], argv[0]);
+        return 1;
+    }
+    long long tupleCount = atoll(argv[1]);
+    char *outputFilename = argv[2];
+    if (tupleCount < 1 || tupleCount > 0x7fffffffLL)
+    {
+        fprintf(stderr, "%s: 1 to %d tuples\n", argv[0], 0x7fffffff);
+        return 1;
+    }
+
+    // a seed given makes the data reproducible
+    srand(argc == 4 ? atoi(argv[3]) : time(NULL));
+    key = ((unsigned long long) rand() << 31) ^ rand();
+    for (mask = 1, shift = 1; mask < (unsigned long long) tupleCount - 1; )
+    {
+        mask = mask * 2 + 1;
+        if (mask >> (2 * shift))
+            shift++;
+    }
+
+    FILE *out = fopen(outputFilename, "wb");
+    if (NULL == out)
+    {
+        perror("Error opening file for writing\n");
+        return 1;
+    }
+    setvbuf(out, NULL, _IOFBF, 1 << 20);
+
+    static const char cycle[] = "AHOV";
+    WiscTuple t;
+    for (long long i = 0; i < tupleCount; i++)
+    {
+        t.unique2 = (int) i;
+        t.unique1 = permute(i, tupleCount);
+        t.two = t.unique1 % 2;
+        t.four = t.unique1 % 4;
+        t.ten = t.unique1 % 10;
+        t.twenty = t.unique1 % 20;
+        t.onePercent = t.unique1 % 100;
+        t.tenPercent = t.unique1 % 10;
+        t.twentyPercent = t.unique1 % 5;
+        t.fiftyPercent = t.unique1 % 2;
+        t.unique3 = t.unique1;
+        t.evenOnePercent = t.onePercent * 2;
+        t.oddOnePercent = t.onePercent * 2 + 1;
+        wiscString(t.stringu1, t.unique1);
+        wiscString(t.stringu2, t.unique2);
+        memset(t.string4, 'x', STRINGLEN);
+        memset(t.string4, cycle[i % 4], 4);
+        if (fwrite(&t, sizeof t, 1, out) != 1)
+        {
+            perror("Error writing tuples\n");
+            return 1;
+        }
+    }
+
+    if (fclose(out) != 0)
+    {
+        perror("Error writing tuples\n");
+        return 1;
+    }
+    printf("Done.\n");
+    return 0;
+
+} // end main
@@ -5,6 +5,7 @@
 #include <functional>
 #include "error.h"
 #include <string.h>
+#include <vector>
 using namespace std;
 
 // define if debug output wanted
@@ -12,6 +13,9 @@ using namespace std;
 //#define DEBUGIO
 //#define DEBUGFREE
 
+// default # of pages that temporary files may hold in memory
+#define TEMPPAGES 16384
+
 // forward class definition for db
 class DB;
 
@@ -30,6 +34,12 @@ class File {
 		   const Page* pagePtr);      // write page to file
   const Status getFirstPage(int& pageNo) const;     // returns pageNo of first page
 
+  // false for a page of a temporary file that is held in memory
+  bool onDisk(const int pageNo) const
+    {
+      return !temp || pageNo >= (int) pages.size() || !pages[pageNo];
+    }
+
   bool operator == (const File & other) const
     {
       return fileName == other.fileName;
@@ -42,6 +52,7 @@ class File {
 
   static const Status create(const string &fileName);
   static const Status destroy(const string &fileName);
+  static const Status scratchAlloc(int & scratchNo);
 
   const Status open();
   const Status close();
@@ -58,6 +69,20 @@ class File {
   string fileName;                    // The name of the file
   int openCnt;                        // # times file has been opened
   int unixFile;                       // unix file stream for file
+
+  // A temporary file has no unix file. Page i is pages[i] in memory,
+  // or page scratch[i] of the scratch file, which all temporary files
+  // share, once the pages in memory reached tempBudget.
+  bool temp;
+  vector<Page*> pages;
+  vector<int> scratch;
+
+  static int tempBudget;		// max. # of pages in memory
+  static int tempPages;			// # of pages in memory
+  static string scratchDir;		// where the scratch file goes
+  static int scratchFile;		// unix file, -1 until needed
+  static int scratchCnt;		// # of pages of the scratch file
+  static vector<int> scratchFree;	// its pages no file uses
 };
 
 class BufMgr;
@@ -104,11 +129,17 @@ class DB {
   ~DB();                                // clean up any remaining open files
 
   const Status createFile(const string & fileName) ;  // create a new file
+  const Status createTempFile(const string & fileName); // create a file
+                                                   // in memory
   const Status destroyFile(const string & fileName) ; // destroy a file, 
                                                            // release all space
   const Status openFile(const string & fileName, File* & file);  // open a file
   const Status closeFile(File* file);         // close a file
 
+  // pages temporary files may hold in memory, and the directory of the
+  // scratch file they spill to
+  void setTempSpace(const int pages, const string & dir);
+
  private:
   OpenFileHashTbl   openFiles;    // list of open files
 };
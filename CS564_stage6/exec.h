@@ -0,0 +1,294 @@
+#ifndef EXEC_H
+#define EXEC_H
+
+#include <sys/time.h>
+#include "catalog.h"
+#include "query.h"
+#include "btree.h"
+#include "joinHT.h"
+
+
+// define if debug output wanted
+//#define DEBUGEXEC
+
+
+// The operators of a pipelined query plan. Each one is an iterator:
+// open() gets it ready, every next() produces one more tuple, and
+// close() releases what it holds; an operator may be opened again
+// after it is closed, which reads its input again from the start.
+//
+// Tuples are not copied from operator to operator. A row holds, for
+// every relation of the FROM list (indexed by its position in it), a
+// pointer to its current tuple: a record on a pinned page, or a copy
+// in a hash table. next() sets the pointers of the relations below
+// the operator and leaves the others alone, and the caller hands it
+// the same row on every call, so that a join can keep an outer tuple
+// while it returns one match after another. A pointer stays valid
+// until the next call of next() on the operator that set it.
+
+typedef const char* Row[MAXRELS];
+
+class Iterator
+{
+ public:
+  virtual ~Iterator() {}
+  virtual const Status open() = 0;
+  // OK, or FILEEOF when there are no more tuples
+  virtual const Status next(Row & row) = 0;
+  virtual const Status close() = 0;
+};
+
+
+// Heap file scan of relation rel, applying the selection pred (if not
+// NULL) to the records on the page.
+
+class ScanIter : public Iterator
+{
+ public:
+  ScanIter(const int rel, const string & relName, const PredDesc *pred,
+	   Status & status);
+  ~ScanIter();
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  int rel;
+  const PredDesc *pred;
+  HeapFileScan *scan;
+};
+
+
+// Reads the tuples of relation rel that satisfy selection pred
+// through the B+-tree on its attribute.
+
+class IndexScanIter : public Iterator
+{
+ public:
+  IndexScanIter(const int rel, const string & relName,
+		const PredDesc *pred, Status & status);
+  ~IndexScanIter();
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  int rel;
+  const PredDesc *pred;
+  BTreeIndex *index;
+  HeapFile *file;
+};
+
+
+// Passes on the rows of child that satisfy every one of preds.
+
+class FilterIter : public Iterator
+{
+ public:
+  FilterIter(Iterator *child, const vector<const PredDesc*> & preds);
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  Iterator *child;
+  vector<const PredDesc*> preds;
+};
+
+
+// Tuple nested loops join: inner is opened again for every row of
+// outer, and the rows that satisfy pred (any, if NULL) are passed on.
+
+class NLJoinIter : public Iterator
+{
+ public:
+  NLJoinIter(Iterator *outer, Iterator *inner, const PredDesc *pred);
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  Iterator *outer;
+  Iterator *inner;
+  const PredDesc *pred;
+  bool haveOuter;		// true while inner is open for an outer row
+};
+
+
+// Index nested loops join: for every row of outer, the tuples of
+// relation rel in the key range pred gives are fetched through the
+// B+-tree on rel's join attribute.
+
+class INLJoinIter : public Iterator
+{
+ public:
+  INLJoinIter(Iterator *outer, const int rel, const string & relName,
+	      const PredDesc *pred, Status & status);
+  ~INLJoinIter();
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  Iterator *outer;
+  int rel;
+  const AttrDesc *outerAttr;	// join attribute of the outer row
+  int outerRel;
+  bool low, high;		// bounds of the key range
+  Operator lowOp, highOp;
+  BTreeIndex *index;
+  HeapFile *file;
+  bool haveOuter;		// true while a range scan is open
+};
+
+
+// Hash join: open() reads the rows of build, tuples of relation rel,
+// into an in-memory hash table on rel's join attribute; every row of
+// probe is then passed on once for each tuple of rel that matches it
+// under the equijoin predicate pred.
+
+class HashJoinIter : public Iterator
+{
+ public:
+  HashJoinIter(Iterator *probe, Iterator *build, const int rel,
+	       const PredDesc *pred, Status & status);
+  ~HashJoinIter();
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+ private:
+  Iterator *probe;
+  Iterator *build;
+  int rel;
+  const AttrDesc *buildAttr;
+  const AttrDesc *probeAttr;
+  int probeRel;
+  int tupleLen;			// length of the tuples of rel
+  int tupleCnt;			// # of tuples in rel
+  joinHashTbl *table;
+  vector<const char*> matches;	// tuples of rel matching the probe row
+  unsigned int nextMatch;
+};
+
+
+// Builds the result tuple of every row of child: projected attribute
+// i is taken from the tuple of relation projRels[i]. The tuple is
+// left in a buffer that tuple() returns.
+
+class ProjectIter : public Iterator
+{
+ public:
+  ProjectIter(Iterator *child, const int projCnt,
+	      const AttrDesc projAttrs[], const int projRels[]);
+  ~ProjectIter();
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+  const char* tuple() const { return outputData; }
+  int length() const { return outputLen; }
+
+ private:
+  Iterator *child;
+  int projCnt;
+  const AttrDesc *projAttrs;
+  const int *projRels;
+  char *outputData;
+  int outputLen;
+};
+
+
+// What an operator did, for EXPLAIN ANALYZE: the time, in ms, and the
+// work of the buffer pool between start() and stop(), summed over
+// calls.
+
+class OpStats
+{
+ public:
+  OpStats();
+  void start();
+  void stop();
+  void sub(const OpStats & other);	// less what other did
+
+  double ms;
+  int hits, misses, reads, writes;
+
+ private:
+  struct timeval started;
+  BufStats before;
+};
+
+
+// Counts the rows child returns for EXPLAIN ANALYZE, and what its
+// open(), next() and close() calls did, which includes what the
+// operators below it did; input1 and input2 count those, or are NULL.
+
+class AnalyzeIter : public Iterator
+{
+ public:
+  AnalyzeIter(Iterator *child, const string & label, AnalyzeIter *input1,
+	      AnalyzeIter *input2);
+  const Status open();
+  const Status next(Row & row);
+  const Status close();
+
+  // prints the line of the operator, depth levels in, and below it
+  // those of its inputs
+  void print(const int depth) const;
+  int rows() const { return rowCnt; }
+  const OpStats & stats() const { return total; }
+
+ private:
+  Iterator *child;
+  string label;
+  AnalyzeIter *inputs[2];
+  int rowCnt;
+  OpStats total;
+};
+
+// The lines of an EXPLAIN ANALYZE report: the header, then one line
+// for an operator, depth levels in, that got in rows (-1 if it reads a
+// relation) and returned out, with what it did along with the operators
+// below it (total) and on its own (self).
+void QU_ExplainHeader();
+void QU_ExplainLine(const int depth, const string & label, const int in,
+		    const int out, const OpStats & total,
+		    const OpStats & self);
+
+// # of tuples of a relation, 0 if it cannot be opened
+const int QU_TupleCnt(const string & relName);
+
+
+// Keeps the k tuples added that come first in the order of their
+// sort keys, values of attribute keyAttr (the largest first if desc),
+// and of tuples with equal keys the ones added first. They are held
+// in a heap with the one that comes last on top, which a tuple that
+// comes before it replaces, so memory holds no more than k tuples of
+// tupleLen bytes and their keys.
+
+class TopK
+{
+ public:
+  TopK(const int k, const AttrDesc & keyAttr, const bool desc,
+       const int tupleLen);
+  void add(const char* key, const char* tuple);
+  // the tuples kept, in order; empties the heap
+  void sorted(vector<const char*> & tuples);
+
+ private:
+  bool before(const int e1, const int e2) const;
+  void siftDown(int i);
+  void store(const int e, const char* key, const char* tuple);
+
+  int k;
+  AttrDesc keyAttr;
+  bool desc;
+  int tupleLen;
+  vector<char> keys;		// entry e: keyAttr.attrLen bytes
+  vector<char> tuples;		// entry e: tupleLen bytes
+  vector<int> seqs;		// entry e: # of tuples added before it
+  vector<int> heap;		// entries, the last in order on top
+  int seq;			// # of tuples added
+};
+
+#endif
@@ -58,8 +58,15 @@ public:
   // return number of records in file
   const int getRecCnt() const;
 
+  // return number of data pages in file
+  const int getPageCnt() const;
+
   // given a RID, read record from file, returning pointer and length
   const Status getRecord(const RID &rid, Record & rec);
+
+  // Move records towards the front of the file and give the pages
+  // that become empty back to the file. All RIDs of the file change.
+  const Status vacuum(int & pagesFreed);
 };
 
 
@@ -88,18 +95,26 @@ public:
     // read current record, returning pointer and length
     const Status getRecord(Record & rec);
 
-    // delete current record 
+    // delete current record. The deletion is applied to the page
+    // together with all other deletions on that page once the scan
+    // moves on to the next page or ends.
     const Status deleteRecord();
 
     // marks current page of scan dirty
     const Status markDirty();
 
+    // Pass on only the records, among those that satisfy the filter,
+    // for which fcn returns true; NULL removes the test. Lets a join
+    // drop tuples that cannot match before they leave the scan.
+    const Status setRecFilter(const bool (*fcn)(const Record & rec));
+
 private:
     int   offset;            // byte offset of filter attribute
     int   length;            // length of filter attribute
     Datatype type;           // datatype of filter attribute
     const char* filter;      // comparison value of filter
     Operator op;             // comparison operator of filter
+    const bool (*recFilter)(const Record & rec); // see setRecFilter()
 
      // The following variables are used to preserve the state
     // of the scan when the method markScan() is invoked.
@@ -108,7 +123,12 @@ private:
     int   markedPageNo;	// page number of pinned page
     RID   markedRec;         // rid of last record returned
 
+    int   prevPageNo;        // page before curPage in the chain, -1 if none
+    vector<RID> deleted;     // deletions not yet applied to curPage
+
     const bool matchRec(const Record & rec) const;
+    const Status applyDeletes();
+    const Status releasePage(const int nextPageNo);
 };
 
 
@@ -125,4 +145,9 @@ public:
     const Status insertRecord(const Record & rec, RID& outRid); 
 };
 
+// create an empty heap file / remove a heap file
+extern const Status createHeapFile(const string fileName,
+				   const bool temp = false);
+extern const Status destroyHeapFile(const string fileName);
+
 #endif
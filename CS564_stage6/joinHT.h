@@ -1,40 +1,65 @@
+#ifndef JOINHT_H
+#define JOINHT_H
+
+// A hash table on a join attribute, used by the hash join for the build
+// tuples held in memory. Every inserted tuple becomes an entry in an
+// arena of fixed size entries: the next entry with the same key, the
+// key value, and a payload of payloadLen bytes that the caller chooses
+// (the whole build tuple, or only the build attributes it projects).
+// The slots are open addressed with linear probing; a slot holds the
+// hash of a key, so that most slots that do not match are passed over
+// without comparing keys, and the first entry of the key.
 
 class joinHashTbl
 {
 private:
-    union JAttrType
-    {
-	int iValue;
-	float fValue;
-	char* sValue;
-    };
-	
-    struct joinhashBucket
+    struct HTslot
     {
-	union JAttrType	attrValue;
-       	RID	rid;
-       	joinhashBucket*     next;    // next node in the hash table
+	unsigned int hash;	// hash of the key
+	int first;		// first entry with the key, -1 if free
     };
 
-    struct HTentry
-    {
-	int bucketCnt;  // nuumber of buckets on this chain
-	joinhashBucket*   chain;  // pointer to first bucket on the chain
-    };
+    AttrDesc	joinAttr;
+    int		keyLen;		// bytes of the join attribute
+    int		payloadLen;	// bytes of payload per entry
+    int		entrySize;	// bytes per entry in the arena
+    int		entryCnt;	// # of entries in the arena
+    int		slotCnt;	// # of slots, a power of two
+    int		keyCnt;		// # of slots in use
+    HTslot	*ht;		// the slots
+    vector<char> arena;	// the entries
 
-    AttrDesc 	joinAttr;
-    int 	HTSIZE;
-    HTentry 	*ht; // actual hash table
-    int  hash(const char* attr, int attrType); // returns value between 0 and HTSIZE-1
+    unsigned int hash(const char* key) const;
+    bool keyEqual(const char* k1, const char* k2) const;
+    int findSlot(const char* key, const unsigned int h) const;
+    void grow();
+
+    int& entryNext(const int e) { return *(int *) &arena[e * entrySize]; }
+    const char* entryKey(const int e) const
+	{ return &arena[e * entrySize] + sizeof(int); }
 
 public:
-    joinHashTbl(const int size, const AttrDesc attr);  // constructor
+    // a table for about size entries, each carrying payloadLen bytes
+    joinHashTbl(const int size, const AttrDesc attr, const int payloadLen);
     ~joinHashTbl();
 
-     // insert a new (JoinAttrValue, RID) pair into hash table
-     Status insert(const RID newRid,  const char* tuple);
+    // bytes of memory an entry takes, slots included
+    static int entryBytes(const AttrDesc & attr, const int payloadLen);
+
+    // # of entries in the table
+    int count() const { return entryCnt; }
+
+    // remove all entries
+    void clear();
+
+    // insert an entry with the join attribute value at key
+    Status insert(const char* key, const char* payload);
 
-     // get RIDs of records whose join attribute value matches innerJoinAttrValue
-     Status lookup(const char* innerJoinAttrPtr, int & ridCount, RID *&outRids);
+    // Append to matches the payloads of the entries whose join attribute
+    // equals the value at key, after clearing it. The caller keeps the
+    // vector from probe to probe, so its storage is reused; the
+    // pointers are valid until the next insert.
+    Status lookup(const char* key, vector<const char*> & matches) const;
 };
 
+#endif
@@ -22,7 +22,13 @@ struct slot_t {
         short	length;  // equals -1 if slot is not in use
 };
 
-const unsigned PAGESIZE = 1024;
+// bytes of a page: 1024 unless built with -DPAGEBYTES=n; no more than
+// 32767, as the slots hold shorts. A data base made with one page size
+// cannot be read with another.
+#ifndef PAGEBYTES
+#define PAGEBYTES 1024
+#endif
+const unsigned PAGESIZE = PAGEBYTES;
 const unsigned DPFIXED= sizeof(slot_t)+4*sizeof(short)+2*sizeof(int);
 const unsigned PAGEDATASIZE = PAGESIZE-DPFIXED+sizeof(slot_t);
 // size of the data area of a page
@@ -59,6 +65,9 @@ public:
     // delete the record with the specified rid
     const Status deleteRecord(const RID & rid);
 
+    // delete cnt records at once, compacting the page only once
+    const Status deleteRecords(const RID rids[], const int cnt);
+
     // returns RID of first record on page
     // returns  NORECORDS if page contains no records.  Otherwise, returns OK
     const Status firstRecord(RID& firstRid) const;
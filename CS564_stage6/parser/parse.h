@@ -57,6 +57,8 @@ typedef enum {
     N_LOAD,
     N_PRINT,
     N_HELP,
+    N_VACUUM,
+    N_ANALYZE,
     N_SELECT,
     N_JOIN,
     N_PRIMATTR,
@@ -65,7 +67,13 @@ typedef enum {
     N_ATTRTYPE,
     N_VALUE,
     N_LIST,
-    N_ALIAS
+    N_ALIAS,
+    N_ORDER,
+    N_AGG,
+    N_EXPLAIN,
+    N_PREPARE,
+    N_EXECUTE,
+    N_PARAM
 } NODEKIND;
 
 
@@ -82,12 +90,17 @@ typedef struct node {
 	    char *relname;
 	    struct node *attrlist;
 	    struct node *qual;
+	    struct node *tablelist;
+	    struct node *group;		// GROUP BY list, or NULL
+	    struct node *order;		// ORDER BY, or NULL
+	    int limit;			// LIMIT, or -1
 	} QUERY;
 
 	// insert node */
 	struct {
 	    char *relname;
-	    struct node *attrlist;
+	    struct node *attrlist;	// attributes, values of the first row
+	    struct node *rows;		// value lists of the other rows
 	} INSERT;
 
 	// delete node */
@@ -137,6 +150,16 @@ typedef struct node {
 	    char *relname;
 	} HELP;
 
+	// vacuum node */
+	struct {
+	    char *relname;
+	} VACUUM;
+
+	// analyze node */
+	struct {
+	    char *relname;
+	} ANALYZE;
+
 	// select node */
 	struct {
 	    struct node *selattr;
@@ -203,6 +226,41 @@ typedef struct node {
 	  char *relname;
 	  char *alias;
 	} ALIAS;
+
+	// order by node */
+	struct {
+	  struct node *orderattr;
+	  int desc;
+	} ORDER;
+
+	// aggregate node */
+	struct {
+	  int func;			// RW_COUNT, RW_SUM, ... token
+	  struct node *aggattr;		// NULL for COUNT(*)
+	} AGG;
+
+	// explain node */
+	struct {
+	  struct node *query;
+	  int analyze;			// EXPLAIN ANALYZE: run the query
+	} EXPLAIN;
+
+	// prepare node */
+	struct {
+	  char *name;
+	  struct node *stmt;		// query, insert or delete
+	} PREPARE;
+
+	// execute node */
+	struct {
+	  char *name;
+	  struct node *values;		// list of values, or NULL
+	} EXECUTE;
+
+	// parameter (?) node */
+	struct {
+	  int num;			// from 0, in the order of the command
+	} PARAM;
     } u;
 } NODE;
 
@@ -211,9 +269,11 @@ typedef struct node {
 // function prototypes
 //
 
+void parse_overflow(void);
 NODE *newnode(int kind);
-NODE *query_node(char *relname, NODE *attrlist, NODE *n);
-NODE *insert_node(char *relname, NODE *attrlist);
+NODE *query_node(char *relname, NODE *attrlist, NODE *n, NODE *tablelist,
+		 NODE *group, NODE *order, int limit);
+NODE *insert_node(char *relname, NODE *attrlist, NODE *rows);
 NODE *delete_node(char *relname, NODE *qual);
 NODE *create_node(char *relname, NODE *attrlist, NODE *primattr);
 NODE *destroy_node(char *relname);
@@ -223,6 +283,13 @@ NODE *drop_node(char *relname, char *attrname);
 NODE *load_node(char *relname, char *filename);
 NODE *print_node(char *relname);
 NODE *help_node(char *relname);
+NODE *vacuum_node(char *relname);
+NODE *analyze_node(char *relname);
+NODE *explain_node(NODE *query, int analyze);
+NODE *prepare_node(char *name, NODE *stmt);
+NODE *execute_node(char *name, NODE *values);
+NODE *param_node(void);
+int param_count(void);
 NODE *select_node(NODE *selattr, int op, NODE *value);
 NODE *join_node(NODE *joinattr1, int op, NODE *joinattr2);
 NODE *qualattr_node(char *relname, char *attrname);
@@ -235,8 +302,11 @@ NODE *float_node(float rval);
 NODE *string_node(char *s);
 NODE *list_node(NODE *n);
 NODE *prepend(NODE *n, NODE *list);
+NODE *reverse(NODE *list);
 NODE *merge_attr_value_list(NODE *attr_list, NODE *value_list);
 NODE *alias_node(char *relname, char *alias);
+NODE *order_node(NODE *orderattr, int desc);
+NODE *agg_node(int func, NODE *aggattr);
 NODE *replace_alias_in_qualattr_list(NODE *alias, NODE *qualattr_list);
 NODE *replace_alias_in_condition(NODE *alias, NODE *where);
 #endif
@@ -5,6 +5,8 @@
 
 #include <stdlib.h>
 #include <stdio.h>
+#include <sys/time.h>
+#include <setjmp.h>
 #include "heapfile.h"
 #include "parse.h"
 
@@ -13,11 +15,16 @@ extern int yylex();
 extern int yywrap();
 extern void reset_scanner();
 extern void quit();
+void parse_command(void);
+extern BufMgr *bufMgr;
+extern bool ShowStats;
+extern bool Serving;
 
 void yyerror(char *);
 
 extern char *yytext;                    // tokens in string format
 static NODE *parse_tree;                // root of parse tree
+static jmp_buf parse_full;              // where parse_overflow() goes
 %}
 
 %union{
@@ -72,13 +79,36 @@ static NODE *parse_tree;                // root of parse tree
 		T_QSTRING
 		T_SHELL_CMD
 
+%token		RW_VACUUM
+%token		RW_ANALYZE
+%token		RW_ORDER
+		RW_BY
+		RW_ASC
+		RW_DESC
+		RW_LIMIT
+%token		RW_GROUP
+		RW_COUNT
+		RW_SUM
+		RW_AVG
+		RW_MIN
+		RW_MAX
+%token		RW_EXPLAIN
+%token		RW_PREPARE
+		RW_EXECUTE
+
 %type	<ival>	op
+		opt_desc
+		opt_limit
+		aggfn
 
 %type	<sval>	opt_into_relname
 		opt_relname
 		string
 
 %type	<n>	command
+		explain
+		prepare
+		execute
 		query
 		insert
 		delete
@@ -92,13 +122,21 @@ static NODE *parse_tree;                // root of parse tree
 		load
 		print
 		help
+		vacuum
+		analyze
 		quit
 		opt_primary_attr
 		opt_where
+		opt_group
+		opt_order
 		qual
+		conjunct_list
+		predicate
 		selection
 		join
 		non_mt_qualattr_list
+		select_list
+		select_item
 		qualattr
 /*
 		non_mt_attrval_list
@@ -107,9 +145,11 @@ static NODE *parse_tree;                // root of parse tree
 		non_mt_attrtype_list
 		attrtype
 		value
+		param_value
 		attrib
 		attrib_list
 		value_list
+		more_rows
 		val
 		table_list
 		table
@@ -125,7 +165,10 @@ start
 	{
 	        if(!isatty(0))
 		    puts($1);
-		(void)system($1);
+		if (Serving)
+		    puts("shell commands are not run by the server");
+		else
+		    (void)system($1);
 		parse_tree = NULL;
 		YYACCEPT;
 	}
@@ -138,11 +181,16 @@ start
 	| T_EOF
 	{
 		quit();
+		parse_tree = NULL;
+		YYACCEPT;
 	}
 	;
 
 command
 	: query
+	| explain
+	| prepare
+	| execute
 	| insert
 	| delete
 	| create
@@ -155,6 +203,8 @@ command
 	| load
 	| print
 	| help
+	| vacuum
+	| analyze
 	| quit
 	| nothing
 	{
@@ -162,8 +212,45 @@ command
 	}
 	;
 
+explain
+	: RW_EXPLAIN query
+	{
+		$$ = explain_node($2, 0);
+	}
+	| RW_EXPLAIN RW_ANALYZE query
+	{
+		$$ = explain_node($3, 1);
+	}
+	;
+
+prepare
+	: RW_PREPARE string RW_AS query
+	{
+		$$ = prepare_node($2, $4);
+	}
+	| RW_PREPARE string RW_AS insert
+	{
+		$$ = prepare_node($2, $4);
+	}
+	| RW_PREPARE string RW_AS delete
+	{
+		$$ = prepare_node($2, $4);
+	}
+	;
+
+execute
+	: RW_EXECUTE string '(' value_list ')'
+	{
+		$$ = execute_node($2, $4);
+	}
+	| RW_EXECUTE string
+	{
+		$$ = execute_node($2, NULL);
+	}
+	;
+
 query
-	: RW_SELECT non_mt_qualattr_list opt_into_relname RW_FROM table_list opt_where
+	: RW_SELECT select_list opt_into_relname RW_FROM table_list opt_where opt_group opt_order opt_limit
 /*	RW_SELECT opt_into_relname '(' non_mt_qualattr_list ')' opt_where */
 	{
 		NODE *where;
@@ -176,8 +263,16 @@ query
 		  if ((where == NULL) && ($6 != NULL)) {
 		     $$ = NULL; //something wrong in where condition
 		  }
+		  else if ($7 != NULL &&
+			   replace_alias_in_qualattr_list($5, $7) == NULL) {
+		     $$ = NULL; //something wrong in group by list
+		  }
+		  else if ($8 != NULL && replace_alias_in_qualattr_list($5,
+				list_node($8->u.ORDER.orderattr)) == NULL) {
+		     $$ = NULL; //something wrong in order by attribute
+		  }
 		  else {
-		    $$ = query_node($3, qualattr_list, where);
+		    $$ = query_node($3, qualattr_list, where, $5, $7, $8, $9);
 		  }
 		}
 	}
@@ -208,11 +303,24 @@ table
 	}
 
 insert
-	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES '(' value_list ')' 
+	: RW_INSERT RW_INTO string '(' attrib_list ')' RW_VALUES '(' value_list ')' more_rows
 	{
 		NODE* tmp = merge_attr_value_list($5, $9);
 		if (tmp == NULL) $$=NULL;
-		else $$ = insert_node($3, tmp);
+		else $$ = insert_node($3, tmp, reverse($11));
+	}
+	;
+
+/* left recursive, so that the parser stack does not grow with the
+   rows; they are collected last first */
+more_rows
+	: more_rows ',' '(' value_list ')'
+	{
+		$$ = prepend($4, $1);
+	}
+	| nothing
+	{
+		$$ = NULL;
 	}
 	;
 
@@ -243,7 +351,7 @@ value_list
 	}
 
 val
-	: value 
+	: param_value 
 	{
 		$$ = $1;
 	}
@@ -316,10 +424,27 @@ help
 	}
 	;
 
+vacuum
+	: RW_VACUUM string
+	{
+		$$ = vacuum_node($2);
+	}
+	;
+
+analyze
+	: RW_ANALYZE string
+	{
+		$$ = analyze_node($2);
+	}
+	;
+
 quit
 	: RW_QUIT ';'
 	{
+		// only returns in a session of the server, which it ends
 		quit();
+		parse_tree = NULL;
+		YYACCEPT;
 	}
 	;
 
@@ -367,13 +492,84 @@ opt_where
 	}
 	;
 
+opt_group
+	: RW_GROUP RW_BY non_mt_qualattr_list
+	{
+		$$ = $3;
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_order
+	: RW_ORDER RW_BY qualattr opt_desc
+	{
+		$$ = order_node($3, $4);
+	}
+	| nothing
+	{
+		$$ = NULL;
+	}
+	;
+
+opt_desc
+	: RW_ASC
+	{
+		$$ = 0;
+	}
+	| RW_DESC
+	{
+		$$ = 1;
+	}
+	| nothing
+	{
+		$$ = 0;
+	}
+	;
+
+opt_limit
+	: RW_LIMIT T_INT
+	{
+		$$ = $2;
+	}
+	| nothing
+	{
+		$$ = -1;
+	}
+	;
+
 qual
+	: conjunct_list
+	{
+		// a single predicate stands for itself, a conjunction is
+		// the list of its predicates
+		if ($1->u.LIST.next == NULL)
+		  $$ = $1->u.LIST.self;
+		else
+		  $$ = $1;
+	}
+	;
+
+conjunct_list
+	: predicate RW_AND conjunct_list
+	{
+		$$ = prepend($1, $3);
+	}
+	| predicate
+	{
+		$$ = list_node($1);
+	}
+	;
+
+predicate
 	: selection
 	| join
 	;
 
 selection
-	: qualattr op value
+	: qualattr op param_value
 	{
 		$$ = select_node($1, $2, $3);
 	}
@@ -401,6 +597,56 @@ non_mt_qualattr_list
 	}
 	;
 
+select_list
+	: '(' select_list ')'
+	{
+		$$ = $2;
+	}
+	| select_item ',' select_list
+	{
+		$$ = prepend($1, $3);
+	}
+	| select_item
+	{
+		$$ = list_node($1);
+	}
+	;
+
+select_item
+	: qualattr
+	| aggfn '(' qualattr ')'
+	{
+		$$ = agg_node($1, $3);
+	}
+	| RW_COUNT '(' qualattr ')'
+	{
+		$$ = agg_node(RW_COUNT, $3);
+	}
+	| RW_COUNT '(' '*' ')'
+	{
+		$$ = agg_node(RW_COUNT, NULL);
+	}
+	;
+
+aggfn
+	: RW_SUM
+	{
+		$$ = RW_SUM;
+	}
+	| RW_AVG
+	{
+		$$ = RW_AVG;
+	}
+	| RW_MIN
+	{
+		$$ = RW_MIN;
+	}
+	| RW_MAX
+	{
+		$$ = RW_MAX;
+	}
+	;
+
 qualattr
 	: string '.' string
 	{
@@ -502,6 +748,14 @@ value
 	}
 	;
 
+param_value
+	: value
+	| '?'
+	{
+		$$ = param_node();
+	}
+	;
+
 string
 	: T_STRING
 	{
@@ -517,21 +771,60 @@ nothing
 
 void parse(void)
 {
-  extern void new_query();
-  extern void interp(NODE *);
-
   for(;;){
 
-    // reset parser and scanner for a new query
-    new_query();
-
     // print a prompt
     printf("%s", PROMPT);
     fflush(stdout);
 
-    // if a query was successfully read, interpret it
-    if(yyparse() == 0 && parse_tree != NULL)
-      interp(parse_tree);
+    parse_command();
+  }
+}
+
+
+// Reads the next command and interprets it; the server calls it for
+// every command of a session.
+
+void parse_command(void)
+{
+  extern void new_query();
+  extern void interp(NODE *);
+
+  // reset parser and scanner for a new query
+  new_query();
+
+  // a command that does not fit in the nodes and strings of the parser
+  // is skipped up to its ';' and not run
+  if (setjmp(parse_full)) {
+    int token;
+    puts("command too long, not run");
+    do {
+      new_query();
+      token = yylex();
+    } while (token != ';' && token != T_EOF);
+    if (token == T_EOF)
+      quit();
+    return;
+  }
+
+  // if a query was successfully read, interpret it; with STATS
+  // report how long it took and what it cost the buffer pool
+  if(yyparse() == 0 && parse_tree != NULL) {
+    struct timeval started, now;
+    if (ShowStats) {
+      bufMgr->clearBufStats();
+      gettimeofday(&started, NULL);
+    }
+    interp(parse_tree);
+    if (ShowStats) {
+      gettimeofday(&now, NULL);
+      const BufStats & stats = bufMgr->getBufStats();
+      printf("    stats: %.3f s, %d buffer accesses, %d pages read, "
+	     "%d pages written\n",
+	     (now.tv_sec - started.tv_sec)
+	     + (now.tv_usec - started.tv_usec) / 1e6,
+	     stats.accesses, stats.diskreads, stats.diskwrites);
+    }
   }
 }
 
@@ -541,3 +834,12 @@ void yyerror(char *s)
   puts(s);
 }
 
+
+// Gives up the command being parsed: called when it needs more parse
+// tree nodes or string space than there is.
+
+void parse_overflow(void)
+{
+  longjmp(parse_full, 1);
+}
+
@@ -78,7 +78,23 @@
      T_REAL = 294,
      T_STRING = 295,
      T_QSTRING = 296,
-     T_SHELL_CMD = 297
+     T_SHELL_CMD = 297,
+     RW_VACUUM = 298,
+     RW_ANALYZE = 299,
+     RW_ORDER = 300,
+     RW_BY = 301,
+     RW_ASC = 302,
+     RW_DESC = 303,
+     RW_LIMIT = 304,
+     RW_GROUP = 305,
+     RW_COUNT = 306,
+     RW_SUM = 307,
+     RW_AVG = 308,
+     RW_MIN = 309,
+     RW_MAX = 310,
+     RW_EXPLAIN = 311,
+     RW_PREPARE = 312,
+     RW_EXECUTE = 313
    };
 #endif
 /* Tokens.  */
@@ -122,6 +138,22 @@
 #define T_STRING 295
 #define T_QSTRING 296
 #define T_SHELL_CMD 297
+#define RW_VACUUM 298
+#define RW_ANALYZE 299
+#define RW_ORDER 300
+#define RW_BY 301
+#define RW_ASC 302
+#define RW_DESC 303
+#define RW_LIMIT 304
+#define RW_GROUP 305
+#define RW_COUNT 306
+#define RW_SUM 307
+#define RW_AVG 308
+#define RW_MIN 309
+#define RW_MAX 310
+#define RW_EXPLAIN 311
+#define RW_PREPARE 312
+#define RW_EXECUTE 313
 
 
 
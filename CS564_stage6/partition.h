@@ -7,6 +7,15 @@
 // define if debug output wanted
 //#define DEBUGPART
 
+// bytes of write-combining buffer of a partition file; a full buffer
+// is written out as about two pages
+#define PARTBUFBYTES (2 * PAGESIZE)
+
+// bytes of buffers one pass fills at a time, about what the L2 cache
+// of a core holds; more partitions than fit are made in several passes
+#define PARTCACHEBYTES (256 * 1024)
+#define PARTMAXFANOUT ((int) (PARTCACHEBYTES / PARTBUFBYTES))
+
 
 class Partition {
  public:
@@ -14,16 +23,28 @@ class Partition {
 	    const string & fileName,             // (base) name of heap file
 	    const int P,                      // number of partitions
 	    const int (*hashfcn)(const Record & rec,
-				 const int P),  
+				 const int P),
 	                               // hash function to use in partitioning
 	    string* &partName,           // names of partitioned heap files
-	    Status &status);            // create partitions of file
+	    Status &status,             // create partitions of file
+	    const Status (*residentfcn)(const Record & rec) = NULL);
+	                  // receives records the hash function keeps resident
   ~Partition();                         // destroy partitions
 
+  const int recCnt(const int p) const;  // # of records in partition p
+  const double skew() const;		// largest partition / mean
+
  private:
+  const Status split(HeapFileScan *scan, const string & base,
+		     const int lo, const int hi, const bool tagged);
+  const Status spread(HeapFileScan *scan, const vector<string> & names,
+		      const int lo, const int span, const bool tagged);
 
   int P;                                // number of partitions
   string *partName;                      // partition names
+  int *recCnts;				// # of records per partition
+  const int (*hashfcn)(const Record & rec, const int P);
+  const Status (*residentfcn)(const Record & rec);
 };
 
 #endif
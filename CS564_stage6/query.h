@@ -1,9 +1,77 @@
 #ifndef QUERY_H
 #define QUERY_H
 
-#include "heapfile.h"
+#include "catalog.h"
 
-enum JoinType {NLJoin, SMJoin, HashJoin};
+enum JoinType {NLJoin, SMJoin, HashJoin, TupleNLJoin, IndexNLJoin,
+	       ParallelHashJoin, CostJoin};
+
+// A join plan: the method, and whether the relation of the first join
+// attribute is the outer (for the hash join, the build) input.
+
+struct JoinPlan {
+  JoinType method;
+  bool outer1;
+  double cost;			// estimated, in sequential page reads
+  double resultCnt;		// estimated # of result tuples
+};
+
+// EXPLAIN of a query: NoExplain runs it, ExplainPlan prints the plan
+// chosen for it without running it, and ExplainAnalyze prints the plan,
+// runs the query and reports what every operator of it did.
+
+enum ExplainType {NoExplain, ExplainPlan, ExplainAnalyze};
+
+// most relations in the FROM list of a query
+#define MAXRELS 10
+
+// The aggregate function of an attribute of a projection list;
+// NoAgg for an attribute of the GROUP BY list. COUNT(*) is CountAgg
+// of an attribute with an empty name.
+
+enum AggFunc {NoAgg, CountAgg, SumAgg, AvgAgg, MinAgg, MaxAgg};
+
+// A predicate of a conjunctive WHERE clause, as the parser hands it
+// over: attr1 op attr2 (a join predicate) if value is NULL, attr1 op
+// value (a selection) otherwise, with value in string form.
+
+struct QueryPred {
+  attrInfo attr1;
+  Operator op;
+  attrInfo attr2;
+  const char *value;
+};
+
+// The same predicate looked up in the catalog. Relations are numbered
+// by their position in the FROM list; rel2 is -1 for a selection,
+// whose value is in binary form.
+
+struct PredDesc {
+  int rel1;
+  AttrDesc attr1;
+  Operator op;
+  int rel2;
+  AttrDesc attr2;
+  const char *value;
+};
+
+// A left-deep plan for a query over several relations. Relation
+// order[0] is read first, and every later relation order[i] is joined
+// to the tuples of the ones before it by method[i] (TupleNLJoin,
+// IndexNLJoin or HashJoin) on predicate pred[i], or by nested loops
+// without one (-1) when no predicate connects it to them. A relation
+// that is scanned applies selection scanPred[r] (-1 if none) in the
+// scan, through the index on its attribute if scanIndex[r].
+
+struct QueryPlan {
+  int order[MAXRELS];
+  JoinType method[MAXRELS];
+  int pred[MAXRELS];
+  int scanPred[MAXRELS];
+  bool scanIndex[MAXRELS];
+  double cost;			// estimated, in sequential page reads
+  double resultCnt;		// estimated # of result tuples
+};
 
 //
 // Prototypes for query layer functions
@@ -24,9 +92,51 @@ const Status QU_Join(const string & result,
 		     const Operator op, 
 		     const attrInfo *attr2);
 
+const Status QU_Query(const string & result,
+		      const int projCnt,
+		      const attrInfo projNames[],
+		      const int relCnt,
+		      const string relNames[],
+		      const int predCnt,
+		      const QueryPred preds[],
+		      const attrInfo *orderAttr = NULL,
+		      const bool desc = false,
+		      const int limit = -1,
+		      const AggFunc aggs[] = NULL,
+		      const int groupCnt = 0,
+		      const attrInfo groupNames[] = NULL);
+
+const int QU_AggType(const AggFunc agg, const int attrType);
+
+const Status QU_PlanJoin(const AttrDesc & attrDesc1,
+			 const Operator op,
+			 const AttrDesc & attrDesc2,
+			 JoinPlan & plan);
+
+const Status QU_PlanSelect(const AttrDesc & attrDesc,
+			   const Operator op,
+			   const char *filter,
+			   bool & useIndex);
+
+const Status QU_PlanQuery(const int relCnt,
+			  const string relNames[],
+			  const int predCnt,
+			  const PredDesc preds[],
+			  QueryPlan & plan);
+
+const char *QU_MethodName(const JoinType method);
+
 const Status QU_Insert(const string & relation, 
 		       const int attrCnt, 
-		       const attrInfo attrList[]);
+		       const attrInfo attrList[],
+		       const int rowCnt = 1);
+
+const Status QU_InsertRecords(const string & relation,
+			      const int attrCnt,
+			      const AttrDesc attrs[],
+			      char *records,
+			      const int recCnt,
+			      const int reclen);
 
 const Status QU_Delete(const string & relation, 
 		       const string & attrName, 
@@ -34,4 +144,41 @@ const Status QU_Delete(const string & relation,
 		       const Datatype type, 
 		       const char *attrValue);
 
+const Status QU_DeleteWhere(const string & relation,
+			    const AttrDesc *attrDesc,
+			    const Operator op,
+			    const Datatype type,
+			    const char *filter,
+			    const int attrCnt,
+			    const AttrDesc attrs[]);
+
+// Prepared statements. A value given as NULL is a parameter, a ? of
+// the statement, bound to a value of EXECUTE; the parameters of an
+// insert are numbered in the order of its attribute list, a selection
+// or a delete has at most one. A prepared select is a selection of one
+// relation with at most one predicate, attr op value, whose result
+// goes to TMPRELNAME.
+
+const Status QU_PrepareInsert(const string & name,
+			      const string & relation,
+			      const int attrCnt,
+			      const attrInfo attrList[]);
+
+const Status QU_PrepareSelect(const string & name,
+			      const int projCnt,
+			      const attrInfo projNames[],
+			      const attrInfo *attr,
+			      const Operator op,
+			      const char *attrValue);
+
+const Status QU_PrepareDelete(const string & name,
+			      const string & relation,
+			      const string & attrName,
+			      const Operator op,
+			      const char *attrValue);
+
+const Status QU_Execute(const string & name,
+			const int valueCnt,
+			const attrInfo values[]);
+
 #endif
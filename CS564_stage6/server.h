@@ -0,0 +1,33 @@
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <string>
+#include "error.h"
+
+using namespace std;
+
+// define if debug output wanted
+//#define DEBUGSERVER
+
+// The server speaks the query language: a client sends commands as it
+// would type them, and gets back what minirel would print, the prompt
+// after every command included. An address is the path of a Unix
+// domain socket if it has a /, or else a TCP port on localhost.
+
+#define SVBACKLOG 64			// connections waiting to be accepted
+#define SVPROMPT "\n>>> "		// ends every reply, as PROMPT of
+					// the parser
+
+//
+// Prototypes for server functions
+//
+
+const Status SV_Serve(const string & address);
+
+void SV_EndSession(void);
+
+const Status SV_Listen(const string & address, int & sock);
+
+const Status SV_Connect(const string & address, int & sock);
+
+#endif
@@ -7,24 +7,15 @@
 //#define DEBUGSORT
 
 
-// SORTREC is an in-memory sort record that qsort(3) sorts.
-// The sort attribute as well as the associated RID are
-// stored in the record. The RID is used for fetching the
-// full record when it is needed.
-
-typedef struct {
-  RID rid;                              // record id of current record
-  char* field;                          // pointer to field
-  int length;                           // length of field
-} SORTREC;
-
-
 class SortedFile {
  public:
   SortedFile(const string & fileName, 
 	     int offset,// sort source file on the given
 	     int length, Datatype type, // attribute
-	     int maxItems, Status& status);
+	     int maxItems, Status& status,
+	     int maxRuns = 0,           // max. # of runs read at a time
+	     int threads = 1,           // threads that sort and merge
+	     bool desc = false);        // descending order
 
   Status next(Record & rec);            // fetch next record in sort order
   Status setMark();                     // record a position in sort sequence
@@ -33,11 +24,18 @@ class SortedFile {
 
  private:
   Status sortFile();                    // split source file into sub-runs
-  Status generateRun(int numItems);     // generate one sub-run of file
-  Status startScans();                  // start a scan on each sorted run
+  Status sortParallel();                // the same with several threads
+  Status mergeRuns();                   // merge runs until few are left
+  Status startScans(int first, int cnt); // start a scan on each of cnt
+                                        // runs and merge them
+  Status checkSorted(bool & sorted);    // is source file in order already?
+  int attrCmp(char* p1, char* p2);      // reccmp() in the sort order
+  void attrKey(char* out, const char* attr); // normKey() in the sort
+                                        // order
 
   typedef struct {
     string name;                        // name of run file
+    bool temp;                          // TRUE if run file is temporary
     HeapFileScan* inFile;               // ptr to input file
     InsertFileScan* outFile;		// ptr to output file
     int valid;                          // TRUE if recPtr has a record
@@ -48,16 +46,63 @@ class SortedFile {
 
   vector<RUN> runs;                   // holds info about each sub-run
 
-  HeapFile* hfile;                   // source file to sort
+  Status newRun(RUN & run);             // create a temporary run file
+  Status mergeGroup(int first, int cnt, RUN & run); // merge cnt runs
+                                        // into a new run
+  Status readTuple(int slot, int run, bool & got); // next source
+                                        // tuple into slot, for run
+  Status putTuple(int slot, const Record & rec); // copy rec into slot
+  Status mergeParallel(int first, int cnt, RUN & run); // mergeGroup()
+                                        // with several threads
+  void siftDown(int i);                 // restore heap order below i
+  Status fetch(int i);                  // read next record of run i
+  bool less(int i, int j);              // run i's record before run j's?
+  int playTree(int node);               // winner of subtree at node
+  Status nextRun(RUN* & run);           // run with the next record
+
+  // Loser tree over the runs being merged, runs[treeFirst] to
+  // runs[treeFirst + treeCnt - 1], numbered from 0 here. Leaf i is
+  // node treeCnt + i and node n has children 2n and 2n + 1; tree[n]
+  // is the run that lost the comparison at internal node n, and
+  // tree[0] the run with the smallest record.
+  vector<int> tree;
+  int treeFirst;
+  int treeCnt;
+  bool treeBuilt;                       // false until first next()
+  int pending;                          // run whose record was handed
+                                        // out last, -1 if none
+  vector<int> markTree;                 // tree and treeBuilt at the
+  bool markBuilt;                       // last setMark()
+
   HeapFileScan* hfs;                   // source file to sort
   string fileName;                      // name of source file to sort
   Datatype type;                        // type of sort attribute
   int offset;                           // offset of sort attribute
   int length;                           // length of sort attribute
+  bool desc;                            // largest value first
 
-  SORTREC* buffer;                      // in-memory sort buffer
+  // Run generation holds up to maxItems source tuples in memory, each
+  // in a slot with a heap key: the run the tuple goes to, its sort
+  // attribute in normalized form (see normKey() in sort.C) and its
+  // position in the source file, which keeps equal keys in source
+  // order, so that memcmp on heap keys gives the order of output.
+  // mergeParallel() uses the slots for tuples read from runs, with
+  // keys of the normalized attribute, the run and the position in it.
+  char* keys;                           // heap keys, keyLen bytes
+  int keyLen;
+  char* tuples;                         // tuples, tupleLen bytes
+  int tupleLen;                         // length of the longest tuple
+  vector<int> slotLen;                  // length of the tuple in a slot
+  vector<int> heap;                     // slots in heap order
+  int seq;                              // # of source tuples read
   int maxItems;                         // max. # of items/tuples in buffer
-  int numItems;                         // current # of items in buffer
+  int maxRuns;                          // max. # of runs next() merges,
+                                        // 0 if only the frames limit it
+  int threads;                          // > 1: sort in parallel, and
+                                        // merge the runs into one
+  int id;                               // distinguishes run files of
+                                        // SortedFiles on the same file
+  int runCnt;                           // # of run files written
 };
 
 #endif
@@ -0,0 +1,122 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <time.h>
+#include <string>
+#include "error.h"
+
+using namespace std;
+
+// define to compile the tracepoints out
+//#define NOTRACE
+
+// events a thread keeps; once that many are recorded the oldest ones
+// are overwritten
+#define TRACEEVENTS 65536
+
+
+// One recorded event. cat and name are string constants, never
+// copied. A span (phase 'X') lasts dur ns from ts, 'B' and 'E' begin
+// and end a span of the same thread, 'i' is an instant.
+
+struct TraceEvent {
+  const char *cat;			// category: buf, io, scan, sort, join
+  const char *name;
+  char phase;				// 'X', 'B', 'E' or 'i'
+  int arg;				// page, run, thread...; -1 if none
+  int tid;				// of the thread that recorded it
+  long long ts;				// ns since tracing was enabled
+  long long dur;			// ns, of an 'X' event
+};
+
+
+// The events of one thread. Only the thread itself writes its ring,
+// so recording takes no lock; head counts the events ever recorded
+// and is published after the event is in place. The ring of a thread
+// that exits is free for the next thread that starts, which gets a
+// tid of its own: the events keep the tid of the thread that recorded
+// them, so threads that share a ring over time still get a lane each.
+
+struct TraceRing {
+  TraceEvent events[TRACEEVENTS];
+  unsigned long long head;
+  int tid;				// of its thread: 1, 2, ... as they start
+  int free;				// its thread has exited
+  TraceRing *next;			// list of all rings
+};
+
+
+// Tracing is off until enable() is called, and on is the only thing a
+// tracepoint looks at then. The events are written to the trace file
+// in the Chrome trace event format (chrome://tracing, Perfetto) when
+// the program exits, after all other threads are done.
+
+class Trace {
+ public:
+  static bool on;			// record events
+
+  static void enable(const string & fileName);
+  static const Status dump();		// write the trace file
+
+  static long long now()		// ns since enable()
+  {
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (long long) t.tv_sec * 1000000000LL + t.tv_nsec - started;
+  }
+
+  static void record(const char *cat, const char *name, const char phase,
+		     const long long ts, const long long dur, const int arg);
+
+ private:
+  static TraceRing *newRing();		// of the calling thread
+
+  static string fileName;
+  static long long started;
+  static TraceRing *rings;		// pushed to without a lock
+  static int tidCnt;
+};
+
+
+// Records a span from its construction to its destruction.
+
+class TraceScope {
+ public:
+  TraceScope(const char *cat, const char *name, const int arg = -1)
+    : cat(cat), name(name), arg(arg), ts(Trace::on ? Trace::now() : -1) {}
+  ~TraceScope()
+  {
+    if (ts >= 0)
+      Trace::record(cat, name, 'X', ts, Trace::now() - ts, arg);
+  }
+
+ private:
+  const char *cat;
+  const char *name;
+  int arg;
+  long long ts;				// -1 if tracing was off
+};
+
+
+// The tracepoints. TRACE_SCOPE records the rest of the enclosing
+// block, TRACE_BEGIN and TRACE_END a span that is not a block.
+
+#ifdef NOTRACE
+#define TRACE_SCOPE(cat, name, arg)
+#define TRACE_BEGIN(cat, name, arg)
+#define TRACE_END(cat, name, arg)
+#define TRACE_INSTANT(cat, name, arg)
+#else
+#define TRACE_JOIN2(a, b) a##b
+#define TRACE_JOIN(a, b) TRACE_JOIN2(a, b)
+#define TRACE_SCOPE(cat, name, arg) \
+  TraceScope TRACE_JOIN(traceScope, __LINE__)(cat, name, arg)
+#define TRACE_EVENT(cat, name, phase, arg) \
+  do { if (Trace::on) \
+	 Trace::record(cat, name, phase, Trace::now(), 0, arg); } while (0)
+#define TRACE_BEGIN(cat, name, arg) TRACE_EVENT(cat, name, 'B', arg)
+#define TRACE_END(cat, name, arg) TRACE_EVENT(cat, name, 'E', arg)
+#define TRACE_INSTANT(cat, name, arg) TRACE_EVENT(cat, name, 'i', arg)
+#endif
+
+#endif